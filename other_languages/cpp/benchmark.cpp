@@ -0,0 +1,203 @@
+#include "simpleargumentsparser.hpp"
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <new>
+
+using Clock = std::chrono::steady_clock;
+
+// Cuenta las reservas de memoria para comprobar que reparse() no reserva tras el calentamiento
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+  allocations++;
+  if (void* ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+double elapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void benchLists(size_t count) {
+  std::string ids;
+  ids.reserve(count * 8);
+  for (size_t i = 0; i < count; i++) {
+    if (i > 0) ids += ',';
+    ids += std::to_string((i * 7919) % count);
+  }
+
+  std::string flag = "--ids";
+  char* argv[] = {const_cast<char*>("benchmark"), &flag[0], &ids[0]};
+  CLI cli = CLI::parse(3, argv);
+
+  std::vector<int64_t> numbers;
+  std::vector<std::string_view> views;
+  int rounds = count >= 1000000 ? 3 : 20;
+
+  auto start = Clock::now();
+  for (int r = 0; r < rounds; r++) cli.c["ids"].splitInto(views);
+  double splitMs = elapsedMs(start) / rounds;
+
+  start = Clock::now();
+  for (int r = 0; r < rounds; r++) cli.getLongInts("ids", numbers);
+  double intsMs = elapsedMs(start) / rounds;
+
+  start = Clock::now();
+  for (int r = 0; r < rounds; r++) cli.getLongInts("ids", numbers, ',', true, true);
+  double uniqueMs = elapsedMs(start) / rounds;
+
+  double mb = ids.size() / (1024.0 * 1024.0);
+  std::cout << std::setw(10) << count
+            << std::setw(12) << std::fixed << std::setprecision(3) << splitMs << " ms"
+            << std::setw(10) << std::setprecision(0) << mb / (splitMs / 1000.0) << " MB/s"
+            << std::setw(12) << std::setprecision(3) << intsMs << " ms"
+            << std::setw(10) << std::setprecision(0) << mb / (intsMs / 1000.0) << " MB/s"
+            << std::setw(12) << std::setprecision(3) << uniqueMs << " ms" << "\n";
+}
+
+struct CommandLine {
+  std::vector<const char*> args;
+};
+
+// Líneas distintas a propósito: las mismas opciones cambian entre string y booleano,
+// aparecen en otro orden y los posicionales cambian de longitud
+std::vector<CommandLine> replLines() {
+  const char* path = "/var/tmp/reports/2024/quarterly-summary.json";
+  const char* name = "a-value-that-is-much-longer-than-the-small-string-buffer";
+  return {
+    {{"repl", "--output", path, "-v", "--count", "10", "-xyz", "a-positional-argument-longer-than-sso", "--", "tail"}},
+    {{"repl", "--name", name, "--flag", "-x"}},
+    {{"repl", "--flag", "--name", "-x", name}},
+    {{"repl", "short", "--output", "--count", "another-positional-argument-that-is-long", "-v", path}},
+    {{"repl", "--long-option-name-over-sso", "value", "-abc", "--", "--output", "o.txt", "p"}},
+    {{"repl", "status"}}
+  };
+}
+
+void benchReparse() {
+  std::vector<CommandLine> lines = replLines();
+  const int rounds = 50000;
+  const double total = static_cast<double>(rounds) * lines.size();
+
+  auto start = Clock::now();
+  size_t before = allocations;
+  for (int r = 0; r < rounds; r++) {
+    for (auto& line : lines) {
+      CLI cli = CLI::parse(static_cast<int>(line.args.size()), const_cast<char**>(line.args.data()));
+    }
+  }
+  double freshNs = elapsedMs(start) * 1e6 / total;
+  double freshAllocs = (allocations - before) / total;
+
+  CLI cli;
+  for (int r = 0; r < 10; r++) {
+    for (auto& line : lines) cli.reparse(static_cast<int>(line.args.size()), line.args.data());
+  }
+  start = Clock::now();
+  before = allocations;
+  for (int r = 0; r < rounds; r++) {
+    for (auto& line : lines) {
+      cli.reparse(static_cast<int>(line.args.size()), line.args.data());
+    }
+  }
+  double reuseNs = elapsedMs(start) * 1e6 / total;
+  double reuseAllocs = (allocations - before) / total;
+
+  std::cout << std::fixed << std::setprecision(1)
+            << "  CLI::parse    " << std::setw(8) << freshNs << " ns/line"
+            << std::setw(8) << std::setprecision(2) << freshAllocs << " allocs/line\n"
+            << std::setprecision(1)
+            << "  cli.reparse   " << std::setw(8) << reuseNs << " ns/line"
+            << std::setw(8) << std::setprecision(2) << reuseAllocs << " allocs/line\n";
+}
+
+// Una línea del tamaño de un glob de shell (tool src/**/*.cpp): count argumentos,
+// casi todos rutas, con alguna opción. shift cambia orden y longitudes entre líneas
+std::vector<std::string> globLine(size_t count, size_t shift) {
+  std::vector<std::string> args = {"tool"};
+  for (size_t i = 0; i < count; i++) {
+    size_t n = i + shift;
+    if (n % 50 == 0) {
+      args.push_back("--opt" + std::to_string(n % 400));
+    } else if (n % 50 == 1) {
+      args.push_back("-x");
+    } else {
+      args.push_back("src/module" + std::to_string(n % 17) + "/" + std::string(n % 23, 'f') + std::to_string(n) + ".cpp");
+    }
+  }
+  return args;
+}
+
+void benchLargeLine(size_t count) {
+  std::vector<std::string> first = globLine(count, 0);
+  std::vector<std::string> second = globLine(count, 7);
+  std::vector<const char*> lines[2];
+  for (const auto& arg : first) lines[0].push_back(arg.c_str());
+  for (const auto& arg : second) lines[1].push_back(arg.c_str());
+  int argc = static_cast<int>(lines[0].size());
+  const int rounds = count >= 50000 ? 4 : (count >= 10000 ? 20 : 200);
+  const double total = rounds * 2.0;
+
+  auto start = Clock::now();
+  size_t before = allocations;
+  for (int r = 0; r < rounds; r++) {
+    for (auto& line : lines) {
+      CLI cli = CLI::parse(argc, const_cast<char**>(line.data()));
+    }
+  }
+  double freshMs = elapsedMs(start) / total;
+  double freshAllocs = (allocations - before) / total;
+
+  CLI cli;
+  for (int r = 0; r < 3; r++) {
+    for (auto& line : lines) cli.reparse(argc, line.data());
+  }
+  start = Clock::now();
+  before = allocations;
+  for (int r = 0; r < rounds; r++) {
+    for (auto& line : lines) {
+      cli.reparse(argc, line.data());
+    }
+  }
+  double reuseMs = elapsedMs(start) / total;
+  double reuseAllocs = (allocations - before) / total;
+
+  std::cout << std::setw(10) << count << std::fixed
+            << std::setw(12) << std::setprecision(3) << freshMs << " ms"
+            << std::setw(10) << std::setprecision(1) << freshAllocs << " allocs"
+            << std::setw(12) << std::setprecision(3) << reuseMs << " ms"
+            << std::setw(10) << std::setprecision(1) << reuseAllocs << " allocs\n";
+}
+
+int main() {
+  std::cout << "List decoding (--ids 1,2,3,...)\n";
+  std::cout << std::setw(10) << "elements"
+            << std::setw(27) << "split"
+            << std::setw(27) << "toInts"
+            << std::setw(15) << "sort+unique" << "\n";
+  for (size_t count = 1000; count <= 10000000; count *= 10) {
+    benchLists(count);
+  }
+
+  std::cout << "\nParsing " << replLines().size() << " different command lines in a cycle (REPL steady state)\n";
+  benchReparse();
+
+  std::cout << "\nParsing glob-sized command lines (two alternating lines)\n";
+  std::cout << std::setw(10) << "arguments"
+            << std::setw(25) << "CLI::parse"
+            << std::setw(25) << "cli.reparse" << "\n";
+  for (size_t count : {1000, 10000, 50000}) {
+    benchLargeLine(count);
+  }
+  return 0;
+}
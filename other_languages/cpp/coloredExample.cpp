@@ -1,7 +1,6 @@
 #include "simpleargumentsparser.hpp"
 #include <iostream>
 #include <cstdlib>
-#include <sstream>
 
 using namespace std;
 
@@ -10,33 +9,22 @@ void exit(const string& msg) {
     std::exit(0);
 }
 
-string getHelpMenu(const CLI& cli) {
-    stringstream help;
-    
-    help << "\n";
-    help << cli.color["bold"]["cyan"]("CLI Color System Showcase") << "\n";
-    help << cli.color["dim"]("=") << string(50, '=') << "\n\n";
-    
-    help << cli.color["bold"]("Usage:") << "\n";
-    help << "  ./colored_example [options]\n\n";
-    
-    help << cli.color["bold"]("Options:") << "\n";
-    help << "  " << cli.color["green"]("--showcase") << "      Show complete color showcase\n";
-    help << "  " << cli.color["green"]("--styles") << "        Show text styles (bold, italic, etc.)\n";
-    help << "  " << cli.color["green"]("--colors") << "        Show basic colors\n";
-    help << "  " << cli.color["green"]("--bright") << "        Show bright colors\n";
-    help << "  " << cli.color["green"]("--backgrounds") << "   Show background colors\n";
-    help << "  " << cli.color["green"]("--combinations") << "  Show style combinations\n";
-    help << "  " << cli.color["green"]("--all") << "           Show everything\n";
-    help << "  " << cli.color["green"]("-h, --help") << "      Show this help menu\n";
-    help << "  " << cli.color["green"]("--version") << "       Show version\n\n";
-    
-    help << cli.color["bold"]("Examples:") << "\n";
-    help << "  " << cli.color["dim"]("$") << " ./colored_example --showcase\n";
-    help << "  " << cli.color["dim"]("$") << " ./colored_example --colors --bright\n";
-    help << "  " << cli.color["dim"]("$") << " ./colored_example --all\n";
-    
-    return help.str();
+CLIOptions getOptions() {
+    CLIOptions options("coloredExample");
+    options.summary("CLI Color System Showcase")
+           .add("", "showcase", "Show complete color showcase")
+           .add("", "styles", "Show text styles (bold, italic, etc.)")
+           .add("", "colors", "Show basic colors")
+           .add("", "bright", "Show bright colors")
+           .add("", "backgrounds", "Show background colors")
+           .add("", "combinations", "Show style combinations")
+           .add("", "all", "Show everything")
+           .add("h", "help", "Show this help menu")
+           .add("", "version", "Show version")
+           .example("./coloredExample --showcase")
+           .example("./coloredExample --colors --bright")
+           .example("./coloredExample --all");
+    return options;
 }
 
 void showStyles(const CLI& cli) {
@@ -94,10 +82,14 @@ void showCombinations(const CLI& cli) {
 }
 
 int main(int argc, char* argv[]) {
-    CLI cli = parseCLI(argc, argv);
+    const CLIOptions options = getOptions();
+    CLI cli = parseCLI(argc, argv, options);
     
     if (cli.noArgs)                  exit("Arguments needed. Try: --showcase or --help");
-    if (cli.s["h"] || cli.c["help"]) exit(getHelpMenu(cli));
+    if (cli.s["h"] || cli.c["help"]) {
+        cli.printHelp();
+        return 0;
+    }
     if (cli.c["version"])            exit("V1.0.0");
     
     if (cli.c["showcase"]) {
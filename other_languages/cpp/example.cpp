@@ -8,7 +8,15 @@ void exit(const std::string& msg) {
 }
 
 int main(int argc, char* argv[]) {
-  CLI cli = parseCLI(argc, argv);
+  CLIOptions options("example");
+  options.add("h", "help", "Show this help menu")
+         .add("v", "verbose", "Verbose output")
+         .add("s", "", "Say hello")
+         .add("", "version", "Show version")
+         .add("", "debug-arguments", "Print parsed arguments as JSON");
+
+  // ./example __completion bash|zsh|fish  ->  completion script
+  CLI cli = parseCLI(argc, argv, options);
 
   bool verbose = false;
 
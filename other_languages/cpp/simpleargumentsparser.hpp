@@ -9,17 +9,20 @@
 #include <sstream>
 #include <algorithm>
 #include <cctype>
-#include <regex>
-#include <variant>
 #include <iomanip>
 #include <cstring>
 #include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <charconv>
+#include <string_view>
 
 #ifdef _WIN32
 #include <windows.h>
 #include <io.h>
 #else
 #include <unistd.h>
+#include <sys/ioctl.h>
 #endif
 
 namespace ANSI {
@@ -56,72 +59,225 @@ namespace ANSI {
   constexpr const char* BG_WHITE = "\033[47m";
 }
 
+// Objetos retirados (strings, nodos de mapa) agrupados por capacidad en listas
+// de potencias de dos, para reutilizar uno donde quepa un tamaño dado en O(1)
+template <typename T>
+class SparePool {
+  private:
+    static constexpr size_t classCount = sizeof(size_t) * 8 + 1;
+    std::vector<std::pair<size_t, T>> lists[classCount];
+    size_t count = 0;
+
+    // Número de bits de n: la clase k guarda capacidades en [2^(k-1), 2^k)
+    static size_t sizeClass(size_t n) {
+      size_t k = 0;
+      while (n) {
+        k++;
+        n >>= 1;
+      }
+      return k;
+    }
+
+    T pop(size_t k) {
+      T item = std::move(lists[k].back().second);
+      lists[k].pop_back();
+      count--;
+      return item;
+    }
+
+  public:
+    bool empty() const {
+      return count == 0;
+    }
+
+    void put(T&& item, size_t capacity) {
+      lists[sizeClass(capacity)].emplace_back(capacity, std::move(item));
+      count++;
+    }
+
+    // Devuelve el de menor clase donde quepa size; si ninguno cabe, el mayor disponible
+    T take(size_t size) {
+      size_t k = sizeClass(size);
+      if (!lists[k].empty() && lists[k].back().first >= size) return pop(k);
+      for (size_t j = k + 1; j < classCount; j++) {
+        if (!lists[j].empty()) return pop(j);
+      }
+      for (size_t j = k + 1; j-- > 0;) {
+        if (!lists[j].empty()) return pop(j);
+      }
+      return T();
+    }
+};
+
 class JSValue {
   private:
-    std::variant<std::string, bool> value;
+    // El string se conserva aunque el valor pase a ser booleano, así su buffer se reutiliza
+    std::string text;
+    bool flag;
+    bool boolean;
     bool exists;
 
+    // Recorre los campos no vacíos entre delimitadores; f devuelve false para parar
+    template <typename F>
+    static bool forEachField(const std::string& str, char delimiter, F&& f) {
+      const char* cur = str.data();
+      const char* end = cur + str.size();
+      while (cur < end) {
+        const char* hit = static_cast<const char*>(std::memchr(cur, delimiter, end - cur));
+        const char* stop = hit ? hit : end;
+        if (stop != cur && !f(cur, stop)) return false;
+        cur = stop + 1;
+      }
+      return true;
+    }
+
   public:
-    JSValue() : value(std::string("")), exists(false) {}
-    JSValue(const char* s) : value(std::string(s)), exists(true) {}
-    JSValue(const std::string& s) : value(s), exists(true) {}
-    JSValue(bool b) : value(b), exists(true) {}
+    JSValue() : text(""), flag(false), boolean(false), exists(false) {}
+    JSValue(const char* s) : text(s), flag(false), boolean(false), exists(true) {}
+    JSValue(const std::string& s) : text(s), flag(false), boolean(false), exists(true) {}
+    JSValue(bool b) : text(""), flag(b), boolean(true), exists(true) {}
 
     operator bool() const {
       if (!exists) return false;
-      if (std::holds_alternative<bool>(value)) {
-        return std::get<bool>(value);
+      if (boolean) {
+        return flag;
       } else {
-        std::string s = std::get<std::string>(value);
-        return !s.empty() && s != "false" && s != "0";
+        return !text.empty() && text != "false" && text != "0";
       }
     }
 
     std::string toString() const {
       if (!exists) return "";
-      if (std::holds_alternative<std::string>(value)) {
-        return std::get<std::string>(value);
+      if (!boolean) {
+        return text;
       } else {
-        return std::get<bool>(value) ? "true" : "false";
+        return flag ? "true" : "false";
       }
     }
 
-    bool isString() const { return exists && std::holds_alternative<std::string>(value); }
-    bool isBool() const { return exists && std::holds_alternative<bool>(value); }
+    bool isString() const { return exists && !boolean; }
+    bool isBool() const { return exists && boolean; }
     bool existsValue() const { return exists; }
+    size_t capacity() const { return text.capacity(); }
+
+    // Las vistas apuntan al string guardado: válidas mientras este JSValue no cambie
+    size_t splitInto(std::vector<std::string_view>& out, char delimiter = ',',
+        bool sort = false, bool unique = false) const & {
+      out.clear();
+      if (!isString()) return 0;
+      out.reserve(std::count(text.begin(), text.end(), delimiter) + 1);
+      forEachField(text, delimiter, [&out](const char* first, const char* last) {
+        out.emplace_back(first, static_cast<size_t>(last - first));
+        return true;
+      });
+      if (sort || unique) std::sort(out.begin(), out.end());
+      if (unique) out.erase(std::unique(out.begin(), out.end()), out.end());
+      return out.size();
+    }
+
+    std::vector<std::string_view> split(char delimiter = ',', bool sort = false, bool unique = false) const & {
+      std::vector<std::string_view> result;
+      splitInto(result, delimiter, sort, unique);
+      return result;
+    }
+
+    // Sobre un temporal (p. ej. operator[] const de JSMap) las vistas quedarían colgando
+    size_t splitInto(std::vector<std::string_view>& out, char delimiter = ',',
+        bool sort = false, bool unique = false) const && = delete;
+    std::vector<std::string_view> split(char delimiter = ',', bool sort = false, bool unique = false) const && = delete;
+
+    // Decodifica "1,2,3" en out reutilizando su capacidad; false si algún campo no es un entero
+    bool toInts(std::vector<int64_t>& out, char delimiter = ',',
+        bool sort = false, bool unique = false) const {
+      out.clear();
+      if (!isString()) return false;
+      out.reserve(std::count(text.begin(), text.end(), delimiter) + 1);
+      bool ok = forEachField(text, delimiter, [&out](const char* first, const char* last) {
+        int64_t number = 0;
+        auto res = std::from_chars(first, last, number);
+        if (res.ec != std::errc() || res.ptr != last) return false;
+        out.push_back(number);
+        return true;
+      });
+      if (!ok) {
+        out.clear();
+        return false;
+      }
+      if (sort || unique) std::sort(out.begin(), out.end());
+      if (unique) out.erase(std::unique(out.begin(), out.end()), out.end());
+      return true;
+    }
 
     JSValue& operator=(const std::string& val) {
-      value = val;
-      exists = true;
-      return *this;
+      return assign(val.data(), val.size());
     }
 
     JSValue& operator=(const char* val) {
-      value = std::string(val);
-      exists = true;
-      return *this;
+      return assign(val, std::strlen(val));
     }
 
     JSValue& operator=(bool val) {
-      value = val;
+      text.clear();
+      flag = val;
+      boolean = true;
       exists = true;
       return *this;
     }
 
     JSValue& operator=(int val) {
-      value = (val != 0);
+      return *this = (val != 0);
+    }
+
+    // Reutiliza el buffer del string guardado
+    JSValue& assign(const char* data, size_t size) {
+      text.assign(data, size);
+      flag = false;
+      boolean = false;
       exists = true;
       return *this;
     }
+
+    void reset() {
+      text.clear();
+      flag = false;
+      boolean = false;
+      exists = false;
+    }
 };
 
 class JSMap {
   private:
     std::unordered_map<std::string, JSValue> data;
+    // Nodos retirados por clear(), listos para reutilizarse sin reservar memoria
+    SparePool<std::unordered_map<std::string, JSValue>::node_type> spare;
 
   public:
+    JSMap() = default;
+    JSMap(const JSMap& other) : data(other.data) {}
+    JSMap(JSMap&&) = default;
+
+    JSMap& operator=(const JSMap& other) {
+      data = other.data;
+      return *this;
+    }
+
+    JSMap& operator=(JSMap&&) = default;
+
     JSValue& operator[](const std::string& key) {
-      return data[key];
+      return slot(key, 0);
+    }
+
+    // Como operator[], pero si hay que reutilizar un nodo elige uno cuyo buffer
+    // tenga sitio para un valor de valueSize bytes
+    JSValue& slot(const std::string& key, size_t valueSize) {
+      auto it = data.find(key);
+      if (it != data.end()) return it->second;
+      if (spare.empty()) return data[key];
+
+      auto node = spare.take(valueSize);
+      node.key() = key;
+      node.mapped().reset();
+      return data.insert(std::move(node)).position->second;
     }
 
     JSValue operator[](const std::string& key) const {
@@ -134,6 +290,11 @@ class JSMap {
       return data.find(key) != data.end();
     }
 
+    const JSValue* find(const std::string& key) const {
+      auto it = data.find(key);
+      return it != data.end() ? &it->second : nullptr;
+    }
+
     std::vector<std::string> keys() const {
       std::vector<std::string> result;
       for (const auto& pair : data) {
@@ -149,6 +310,15 @@ class JSMap {
     bool empty() const {
       return data.empty();
     }
+
+    // Vacía el mapa conservando buckets, nodos y buffers para el siguiente parseo
+    void clear() {
+      while (!data.empty()) {
+        auto node = data.extract(data.begin());
+        size_t capacity = node.mapped().capacity();
+        spare.put(std::move(node), capacity);
+      }
+    }
 };
 
 class Color {
@@ -240,15 +410,345 @@ class Color {
     }
 };
 
+struct CLIOption {
+  std::string shortName;
+  std::string longName;
+  std::string description;
+  std::string valueName;
+  std::vector<std::string> choices;
+};
+
+class CLIOptions {
+  private:
+    std::string name;
+    std::vector<CLIOption> table;
+    // Índice ordenado de "-x" y "--xxx" para responder prefijos con lower_bound
+    std::vector<std::string> index;
+    std::string summaryText;
+    std::string usageText;
+    std::vector<std::string> examples;
+    // Ayuda ya renderizada: [0] sin color, [1] con color; width 0 = sin generar
+    mutable std::string helpCache[2];
+    mutable int helpWidth[2] = {0, 0};
+
+    static void insertSorted(std::vector<std::string>& list, const std::string& word) {
+      auto it = std::lower_bound(list.begin(), list.end(), word);
+      if (it == list.end() || *it != word) {
+        list.insert(it, word);
+      }
+    }
+
+    static void appendMatches(const std::vector<std::string>& list, const std::string& prefix, std::string& out) {
+      auto it = std::lower_bound(list.begin(), list.end(), prefix);
+      for (; it != list.end() && it->compare(0, prefix.size(), prefix) == 0; ++it) {
+        out += *it;
+        out += '\n';
+      }
+    }
+
+    const CLIOption* findFlag(const std::string& word) const {
+      if (word.size() > 2 && word[0] == '-' && word[1] == '-') {
+        for (const auto& opt : table) {
+          if (word.compare(2, std::string::npos, opt.longName) == 0) return &opt;
+        }
+      } else if (word.size() == 2 && word[0] == '-') {
+        for (const auto& opt : table) {
+          if (opt.shortName.size() == 1 && opt.shortName[0] == word[1]) return &opt;
+        }
+      }
+      return nullptr;
+    }
+
+    static int terminalWidth() {
+      static int width = [] {
+        const char* columns = std::getenv("COLUMNS");
+        if (columns && std::atoi(columns) > 0) return std::atoi(columns);
+#ifdef _WIN32
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+          return static_cast<int>(info.srWindow.Right - info.srWindow.Left + 1);
+        }
+#else
+        struct winsize ws;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0) return static_cast<int>(ws.ws_col);
+#endif
+        return 80;
+      }();
+      return width;
+    }
+
+    static void appendWrapped(std::string& out, const std::string& text, size_t indent, size_t width) {
+      std::istringstream words(text);
+      std::string word;
+      size_t column = 0;
+      while (words >> word) {
+        if (column > 0 && column + 1 + word.size() > width) {
+          out += '\n';
+          out.append(indent, ' ');
+          column = 0;
+        } else if (column > 0) {
+          out += ' ';
+          column++;
+        }
+        out += word;
+        column += word.size();
+      }
+      out += '\n';
+    }
+
+    static std::string flagText(const CLIOption& opt) {
+      std::string flags;
+      if (!opt.shortName.empty()) flags += "-" + opt.shortName;
+      if (!opt.longName.empty()) flags += (flags.empty() ? "    --" : ", --") + opt.longName;
+      if (!opt.valueName.empty()) flags += " " + opt.valueName;
+      return flags;
+    }
+
+    std::string render(bool colored, int width) const {
+      auto paint = [colored](const Color& style, const std::string& text) {
+        return colored ? style(text) : text;
+      };
+      std::string out = "\n";
+
+      if (!summaryText.empty()) {
+        out += paint(Color().bold().cyan(), summaryText) + "\n\n";
+      }
+
+      out += paint(Color().bold(), "Usage:") + "\n  ";
+      out += usageText.empty() ? name + " [options]" : usageText;
+      out += "\n";
+
+      if (!table.empty()) {
+        size_t flagWidth = 0;
+        for (const auto& opt : table) flagWidth = std::max(flagWidth, flagText(opt).size());
+        flagWidth = std::min<size_t>(flagWidth, 28);
+        size_t indent = flagWidth + 4;
+        size_t available = width > static_cast<int>(indent) + 20 ? width - indent : 20;
+
+        out += "\n" + paint(Color().bold(), "Options:") + "\n";
+        for (const auto& opt : table) {
+          std::string flags = flagText(opt);
+          out += "  " + paint(Color().green(), flags);
+          if (flags.size() > flagWidth) {
+            out += "\n";
+            out.append(indent, ' ');
+          } else {
+            out.append(indent - 2 - flags.size(), ' ');
+          }
+
+          std::string description = opt.description;
+          if (!opt.choices.empty()) {
+            description += description.empty() ? "(" : " (";
+            for (size_t i = 0; i < opt.choices.size(); i++) {
+              if (i > 0) description += "|";
+              description += opt.choices[i];
+            }
+            description += ")";
+          }
+          appendWrapped(out, description, indent, available);
+        }
+      }
+
+      if (!examples.empty()) {
+        out += "\n" + paint(Color().bold(), "Examples:") + "\n";
+        for (const auto& example : examples) {
+          out += "  " + paint(Color().dim(), "$") + " " + example + "\n";
+        }
+      }
+      return out;
+    }
+
+    void invalidateHelp() {
+      helpWidth[0] = helpWidth[1] = 0;
+    }
+
+    static std::string functionName(const std::string& prog) {
+      std::string fn = "_";
+      for (char ch : prog) {
+        fn += std::isalnum(static_cast<unsigned char>(ch)) ? ch : '_';
+      }
+      return fn + "_complete";
+    }
+
+  public:
+    CLIOptions(const std::string& programName = "") : name(programName) {}
+
+    CLIOptions& add(const std::string& shortName, const std::string& longName,
+        const std::string& description, const std::string& valueName = "",
+        std::vector<std::string> choices = {}) & {
+      std::sort(choices.begin(), choices.end());
+      if (!shortName.empty()) insertSorted(index, "-" + shortName);
+      if (!longName.empty()) insertSorted(index, "--" + longName);
+      table.push_back({shortName, longName, description, valueName, std::move(choices)});
+      invalidateHelp();
+      return *this;
+    }
+
+    CLIOptions& summary(const std::string& text) & {
+      summaryText = text;
+      invalidateHelp();
+      return *this;
+    }
+
+    CLIOptions& usage(const std::string& text) & {
+      usageText = text;
+      invalidateHelp();
+      return *this;
+    }
+
+    CLIOptions& example(const std::string& text) & {
+      examples.push_back(text);
+      invalidateHelp();
+      return *this;
+    }
+
+    // Encadenar sobre un temporal devuelve un temporal, así parseCLI(argc, argv,
+    // CLIOptions("x").add(...)) cae en la sobrecarga borrada en vez de dejar un puntero colgando
+    CLIOptions&& add(const std::string& shortName, const std::string& longName,
+        const std::string& description, const std::string& valueName = "",
+        std::vector<std::string> choices = {}) && {
+      return std::move(add(shortName, longName, description, valueName, std::move(choices)));
+    }
+
+    CLIOptions&& summary(const std::string& text) && {
+      return std::move(summary(text));
+    }
+
+    CLIOptions&& usage(const std::string& text) && {
+      return std::move(usage(text));
+    }
+
+    CLIOptions&& example(const std::string& text) && {
+      return std::move(example(text));
+    }
+
+    // Se renderiza una vez por variante y ancho; las siguientes llamadas devuelven la caché
+    const std::string& help(bool colored = true, int width = 0) const {
+      if (width <= 0) width = terminalWidth();
+      int variant = colored ? 1 : 0;
+      if (helpWidth[variant] != width) {
+        helpCache[variant] = render(colored, width);
+        helpWidth[variant] = width;
+      }
+      return helpCache[variant];
+    }
+
+    // Una sola escritura; con color solo si stdout es una terminal
+    void printHelp() const {
+#ifdef _WIN32
+      bool colored = _isatty(_fileno(stdout)) != 0;
+#else
+      bool colored = isatty(STDOUT_FILENO) != 0;
+#endif
+      const std::string& text = help(colored);
+      std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+      std::cout.flush();
+    }
+
+    const std::vector<CLIOption>& options() const {
+      return table;
+    }
+
+    const std::string& program() const {
+      return name;
+    }
+
+    std::vector<std::string> complete(const std::string& prefix) const {
+      std::vector<std::string> result;
+      auto it = std::lower_bound(index.begin(), index.end(), prefix);
+      for (; it != index.end() && it->compare(0, prefix.size(), prefix) == 0; ++it) {
+        result.push_back(*it);
+      }
+      return result;
+    }
+
+    // words: argumentos ya escritos, el último es la palabra bajo el cursor
+    std::string completeWords(int count, char* words[]) const {
+      std::string out;
+      std::string current = count > 0 ? words[count - 1] : "";
+      const CLIOption* previous = count > 1 ? findFlag(words[count - 2]) : nullptr;
+
+      if (previous && !previous->valueName.empty()) {
+        appendMatches(previous->choices, current, out);
+      } else if (current.empty() || current[0] == '-') {
+        appendMatches(index, current, out);
+      }
+      return out;
+    }
+
+    std::string completionScript(const std::string& shell, const std::string& prog = "") const {
+      std::string p = prog.empty() ? name : prog;
+      std::string fn = functionName(p);
+      std::stringstream ss;
+
+      // Se invoca el comando tal como se escribió (./mytool, bin/mytool...), no el nombre registrado
+      if (shell == "bash") {
+        ss << fn << "() {\n"
+           << "  local IFS=$'\\n'\n"
+           << "  COMPREPLY=($(\"${COMP_WORDS[0]}\" __complete \"${COMP_WORDS[@]:1:COMP_CWORD}\" 2>/dev/null))\n"
+           << "}\n"
+           << "complete -o default -F " << fn << " " << p << "\n";
+      } else if (shell == "zsh") {
+        ss << "#compdef " << p << "\n"
+           << fn << "() {\n"
+           << "  local -a reply\n"
+           << "  reply=(${(f)\"$(\"$words[1]\" __complete \"${(@)words[2,CURRENT]}\" 2>/dev/null)\"})\n"
+           << "  (( ${#reply} )) && compadd -a reply || _files\n"
+           << "}\n"
+           << "compdef " << fn << " " << p << "\n";
+      } else if (shell == "fish") {
+        // fish no admite una sustitución de comando como nombre de comando: se pasa por una función
+        ss << "function " << fn << "\n"
+           << "    set -l tokens (commandline -opc)\n"
+           << "    $tokens[1] __complete $tokens[2..-1] (commandline -ct) 2>/dev/null\n"
+           << "end\n"
+           << "complete -c " << p << " -a '(" << fn << ")'\n";
+      }
+      return ss.str();
+    }
+
+    // Camino rápido: responde "__complete" y "__completion <shell>" sin leer stdin ni parsear.
+    // Devuelve -1 si argv no es una petición de autocompletado, si no el código de salida
+    int handleCompletion(int argc, char* argv[], std::ostream& out = std::cout) const {
+      if (argc < 2) return -1;
+
+      std::string result;
+      if (std::strcmp(argv[1], "__complete") == 0) {
+        result = completeWords(argc - 2, argv + 2);
+      } else if (std::strcmp(argv[1], "__completion") == 0) {
+        if (argc > 2) {
+          std::string prog = name;
+          if (prog.empty()) {
+            prog = argv[0];
+            size_t slash = prog.find_last_of("/\\");
+            if (slash != std::string::npos) prog = prog.substr(slash + 1);
+          }
+          result = completionScript(argv[2], prog);
+        }
+        if (result.empty()) {
+          std::cerr << "Usage: " << argv[0] << " __completion <bash|zsh|fish>" << std::endl;
+          return 1;
+        }
+      } else {
+        return -1;
+      }
+
+      out.write(result.data(), static_cast<std::streamsize>(result.size()));
+      out.flush();
+      return 0;
+    }
+};
+
 class CLI {
   private:
     JSMap s_obj;
     JSMap c_obj;
-    std::vector<std::pair<std::string, int>> o_vec;
     std::string p_str;
-    std::vector<int> e_vec;
     bool noArgs_bool;
     int argc_int;
+    const CLIOptions* spec = nullptr;
+    std::string key_buf;
+    SparePool<std::string> o_spare;
 
     static std::string getPippedInput() {
       std::string input;
@@ -268,12 +768,25 @@ class CLI {
         return input;
       }
 
-      static bool isValidLongArg(const std::string& arg) {
-        static std::regex pattern("^[a-zA-Z0-9]+(?:-[a-zA-Z0-9]+)*$");
-        return std::regex_match(arg, pattern);
+      // Solo ASCII, como los rangos de la regex; std::isalnum depende del locale
+      static bool isAsciiAlnum(char ch) {
+        return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9');
+      }
+
+      // Equivale a ^[a-zA-Z0-9]+(?:-[a-zA-Z0-9]+)*$ sin pasar por std::regex
+      static bool isValidLongArg(std::string_view arg) {
+        if (arg.empty() || arg.front() == '-' || arg.back() == '-') return false;
+        for (size_t i = 0; i < arg.size(); i++) {
+          if (arg[i] == '-') {
+            if (arg[i - 1] == '-') return false;
+          } else if (!isAsciiAlnum(arg[i])) {
+            return false;
+          }
+        }
+        return true;
       }
 
-      static bool isValidShortArg(const std::string& arg) {
+      static bool isValidShortArg(std::string_view arg) {
         return !arg.empty() && std::all_of(arg.begin(), arg.end(), ::isalpha);
       }
 
@@ -331,24 +844,23 @@ class CLI {
         return false;
       }
 
-      public:
-      JSMap s;
-      JSMap c;
-      std::vector<std::pair<std::string, int>> o;
-      std::string p;
-      std::vector<int> e;
-      bool noArgs;
-      int argc;
-      Color color;
-
-      CLI() : s(s_obj), c(c_obj), noArgs(false), argc(0), color("") {}
+      void pushOther(const char* arg, int index) {
+        if (o_spare.empty()) {
+          o.emplace_back(arg, index);
+          return;
+        }
 
-      static CLI parse(int argc, char* argv[]) {
-        CLI cli;
-        cli.argc = argc - 1;
+        size_t size = std::strlen(arg);
+        o.emplace_back(o_spare.take(size), index);
+        o.back().first.assign(arg, size);
+      }
 
-        cli.p = getPippedInput();
+      JSValue& slot(JSMap& map, std::string_view name, size_t valueSize = 0) {
+        key_buf.assign(name.data(), name.size());
+        return map.slot(key_buf, valueSize);
+      }
 
+      void parseArgs(int argc, const char* const argv[]) {
         bool previousIsArg = false;
 
         for (int i = 1; i < argc; i++) {
@@ -357,69 +869,85 @@ class CLI {
             continue;
           }
 
-          std::string current = argv[i];
-          std::string next = (i + 1 < argc) ? argv[i + 1] : "";
+          std::string_view current = argv[i];
+          std::string_view next = (i + 1 < argc) ? argv[i + 1] : "";
 
           if (!current.empty() && current[0] == '-') {
             if (current.size() > 1 && current[1] == '-') {
               // Argumento largo (--xxx)
               if (current.size() > 2) {
-                std::string name = current.substr(2);
+                std::string_view name = current.substr(2);
 
                 if (isValidLongArg(name)) {
-                  if (!next.empty() && (next[0] == '-' || 
-                        (next.size() > 1 && next[0] == '-' && next[1] == '-'))) {
-                    cli.c[name] = true;
+                  if (!next.empty() && next[0] == '-') {
+                    slot(c, name) = true;
                   } else {
                     if (next.empty()) {
-                      cli.c[name] = true;
+                      slot(c, name) = true;
                     } else {
-                      cli.c[name] = next;
+                      slot(c, name, next.size()).assign(next.data(), next.size());
                     }
                     previousIsArg = !next.empty();
                   }
                 } else {
-                  cli.o_vec.push_back({current, i + 1});
+                  pushOther(argv[i], i + 1);
                 }
               } else {
-                cli.e_vec.push_back(i + 1);
+                e.push_back(i + 1);
               }
             } else {
               // Argumento corto (-x)
               if (current.size() > 1) {
-                std::string name = current.substr(1);
+                std::string_view name = current.substr(1);
 
                 if (isValidShortArg(name)) {
-                  if (!next.empty() && (next[0] == '-' || 
-                        (next.size() > 1 && next[0] == '-' && next[1] == '-'))) {
-                    cli.s[name] = true;
+                  if (!next.empty() && next[0] == '-') {
+                    slot(s, name) = true;
                   } else {
                     if (name.size() > 1) {
                       // Múltiples banderas: -xyz
-                      for (char flag : name) {
-                        cli.s[std::string(1, flag)] = true;
+                      for (size_t j = 0; j < name.size(); j++) {
+                        slot(s, name.substr(j, 1)) = true;
                       }
                     } else {
                       if (next.empty()) {
-                        cli.s[name] = true;
+                        slot(s, name) = true;
                       } else {
-                        cli.s[name] = next;
+                        slot(s, name, next.size()).assign(next.data(), next.size());
                       }
                       previousIsArg = !next.empty();
                     }
                   }
                 } else {
-                  cli.o_vec.push_back({current, i + 1});
+                  pushOther(argv[i], i + 1);
                 }
               }
             }
           } else {
-            cli.o_vec.push_back({current, i + 1});
+            pushOther(argv[i], i + 1);
           }
         }
+      }
+
+      public:
+      JSMap s;
+      JSMap c;
+      std::vector<std::pair<std::string, int>> o;
+      std::string p;
+      std::vector<int> e;
+      bool noArgs;
+      int argc;
+      Color color;
+
+      CLI() : s(s_obj), c(c_obj), noArgs(false), argc(0), color("") {}
+
+      static CLI parse(int argc, char* argv[]) {
+        CLI cli;
+        cli.argc = argc - 1;
+
+        cli.p = getPippedInput();
 
-        cli.o = cli.o_vec;
-        cli.e = cli.e_vec;
+        cli.parseArgs(argc, argv);
 
         if (cli.p.empty() && cli.argc == 0) {
           cli.noArgs = true;
@@ -428,6 +956,39 @@ class CLI {
         return cli;
       }
 
+      // Deja el CLI vacío sin liberar memoria, para volver a parsear con reparse()
+      void clear() {
+        s.clear();
+        c.clear();
+        for (auto& item : o) {
+          size_t capacity = item.first.capacity();
+          o_spare.put(std::move(item.first), capacity);
+        }
+        o.clear();
+        p.clear();
+        e.clear();
+        noArgs = false;
+        argc = 0;
+      }
+
+      // Pensado para REPLs: tras el calentamiento no reserva memoria. Por defecto no mira stdin
+      CLI& reparse(int argc, const char* const argv[], bool readPipe = false) {
+        clear();
+        this->argc = argc - 1;
+
+        if (readPipe) {
+          p = getPippedInput();
+        }
+
+        parseArgs(argc, argv);
+
+        if (p.empty() && this->argc == 0) {
+          noArgs = true;
+        }
+
+        return *this;
+      }
+
       std::string toJSON(int indent = 2, bool tryUseJQ = false) const {
         std::stringstream ss;
         std::string spaces(indent, ' ');
@@ -551,12 +1112,73 @@ class CLI {
         if (!val.existsValue()) return false;
         return static_cast<bool>(val);
       }
+
+      // El CLI solo guarda la dirección: la tabla tiene que sobrevivirle
+      void setOptions(const CLIOptions& options) {
+        spec = &options;
+      }
+
+      void setOptions(const CLIOptions&& options) = delete;
+
+      std::string help(bool colored = true) const {
+        return spec ? spec->help(colored) : "";
+      }
+
+      void printHelp() const {
+        if (spec) spec->printHelp();
+      }
+
+      std::vector<std::string_view> getList(const std::string& shortName, char delimiter = ',',
+          bool sort = false, bool unique = false) const {
+        const JSValue* val = s.find(shortName);
+        if (!val) return {};
+        return val->split(delimiter, sort, unique);
+      }
+
+      std::vector<std::string_view> getLongList(const std::string& longName, char delimiter = ',',
+          bool sort = false, bool unique = false) const {
+        const JSValue* val = c.find(longName);
+        if (!val) return {};
+        return val->split(delimiter, sort, unique);
+      }
+
+      bool getInts(const std::string& shortName, std::vector<int64_t>& out, char delimiter = ',',
+          bool sort = false, bool unique = false) const {
+        const JSValue* val = s.find(shortName);
+        if (!val) {
+          out.clear();
+          return false;
+        }
+        return val->toInts(out, delimiter, sort, unique);
+      }
+
+      bool getLongInts(const std::string& longName, std::vector<int64_t>& out, char delimiter = ',',
+          bool sort = false, bool unique = false) const {
+        const JSValue* val = c.find(longName);
+        if (!val) {
+          out.clear();
+          return false;
+        }
+        return val->toInts(out, delimiter, sort, unique);
+      }
     };
 
     inline CLI parseCLI(int argc, char* argv[]) {
       return CLI::parse(argc, argv);
     }
 
+    inline CLI parseCLI(int argc, char* argv[], const CLIOptions& options) {
+      int status = options.handleCompletion(argc, argv);
+      if (status >= 0) {
+        std::exit(status);
+      }
+      CLI cli = CLI::parse(argc, argv);
+      cli.setOptions(options);
+      return cli;
+    }
+
+    CLI parseCLI(int argc, char* argv[], const CLIOptions&& options) = delete;
+
     extern Color color;
 
 #define CLI_OPT(obj, key) ((obj).has(key) ? (obj)[key] : JSValue())